@@ -0,0 +1,92 @@
+  /* Hugo Freires 2321223 3WA */
+  /* Saulo Canto 2320940 3WB */
+
+/* Benchmark das operações BigInt numa distribuição mista:
+   80% dos valores vêm de big_val (magnitudes variadas), 20% têm 128 bits.
+
+   gcc -O2 -o benchbigint bigint.c benchbigint.c && ./benchbigint
+   (compare com -DBIGINT_NO_FAST64 para medir o caminho genérico;
+    com -DBIGINT_STATS -pthread mede o custo da instrumentação) */
+
+#include <stdio.h>
+#include <time.h>
+#include "bigint.h"
+
+#define NVALS 4096
+
+static BigInt vals[NVALS];
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* xorshift64: gerador simples e determinístico */
+static unsigned long rng_state = 88172645463325252ul;
+static unsigned long rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void fill_vals(void) {
+    for (int i = 0; i < NVALS; i++) {
+        unsigned long s = rng();
+        big_val(vals[i], (long)s >> ((s & 7) * 4));   /* corta 0..28 bits */
+        if (i % 5 == 0) {                             /* 20%: 128 bits cheios */
+            BigInt hi;
+            big_val(hi, (long)rng());
+            big_shl(hi, hi, 64);
+            big_sum(vals[i], vals[i], hi);
+        }
+    }
+}
+
+/* imprime ns por chamada; 'sink' impede que o compilador descarte o laço */
+static volatile unsigned char sink;
+
+static void report(const char *name, double t0, int reps) {
+    printf("%-12s %8.1f ns\n", name, (now() - t0) / ((double)reps * NVALS) * 1e9);
+}
+
+int main(void) {
+    BigInt r;
+    double t0;
+    int reps = 500;
+
+    fill_vals();
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_mul(r, vals[i], vals[(i + 1) % NVALS]); sink ^= r[3]; }
+    report("big_mul", t0, reps);
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_sum(r, vals[i], vals[(i + 1) % NVALS]); sink ^= r[3]; }
+    report("big_sum", t0, reps);
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_sub(r, vals[i], vals[(i + 1) % NVALS]); sink ^= r[3]; }
+    report("big_sub", t0, reps);
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_sar(r, vals[i], i % 127 + 1); sink ^= r[3]; }
+    report("big_sar", t0, reps);
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_mul_i64(r, vals[i], (long)i * 977 - 5); sink ^= r[3]; }
+    report("big_mul_i64", t0, reps);
+
+    t0 = now();
+    for (int k = 0; k < reps; k++)
+        for (int i = 0; i < NVALS; i++) { big_add_i64(r, vals[i], (long)i * 977 - 5); sink ^= r[3]; }
+    report("big_add_i64", t0, reps);
+
+    return 0;
+}
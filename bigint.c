@@ -5,8 +5,309 @@
 #include <stdio.h>
 #include "string.h"
 
+/* ==== instrumentação opcional (-DBIGINT_STATS) ====
+   Com a flag desligada, BIG_TRACE(op) vira nada: custo zero.
+   Com a flag ligada, cada chamada pública conta +1 num buffer da própria
+   thread (sem locks) e 1 a cada 2^BIG_STATS_SAMPLE_SHIFT chamadas tem o
+   tempo medido (rdtsc com lfence/rdtscp; ns fora de x86), já descontado o
+   custo de um trace vazio. Se <sys/sdt.h> existir, também emite probes USDT
+   bigint:op_entry / bigint:op_return (perf/bpftrace).
+   Só as funções públicas são medidas (ver o fim do arquivo). */
+#ifdef BIGINT_STATS
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BIG_TIME_UNIT "cycles"
+#else
+#define BIG_TIME_UNIT "ns"
+#endif
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define BIG_HAVE_SDT 1
+#endif
+#endif
+
+#define BIG_SAMPLE_MASK ((1ull << BIG_STATS_SAMPLE_SHIFT) - 1)
+
+/* contadores de uma thread: só a dona escreve; leitores usam load relaxado */
+struct big_op_ctr {
+    _Atomic unsigned long long calls;
+    _Atomic unsigned long long samples;
+    _Atomic unsigned long long cycles;
+    _Atomic unsigned long long hist[BIG_STATS_BUCKETS];
+};
+
+struct big_tls_buf {
+    struct big_op_ctr op[BIG_OP_COUNT];
+    struct big_tls_buf *next;   /* na lista de ativos ou na lista livre */
+};
+
+/* big_lock protege as listas, o total das threads encerradas e a linha de
+   base do reset. O caminho quente (contar/medir) nunca toma o lock. */
+static pthread_mutex_t big_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct big_tls_buf *big_live = NULL;   /* buffers de threads vivas */
+static struct big_tls_buf *big_free = NULL;   /* devolvidos no fim da thread, para reuso */
+static int big_nbufs = 0;                     /* buffers já alocados */
+static BigStats big_retired;                  /* contagens de threads encerradas */
+static BigStats big_base;                     /* valores brutos no último reset */
+
+static pthread_once_t big_once = PTHREAD_ONCE_INIT;
+static pthread_key_t big_key;                 /* só para o destrutor de fim de thread */
+static unsigned long long big_overhead = 0;   /* custo de um par início/fim vazio */
+static _Thread_local struct big_tls_buf *big_tls = NULL;
+
+static const char *const big_op_names[BIG_OP_COUNT] = {
+    "big_val", "big_comp2", "big_sum", "big_sub", "big_mul",
+    "big_shl", "big_shr", "big_sar", "big_mul_i64", "big_add_i64"
+};
+
+const char *big_op_name(enum big_op op) {
+    return ((unsigned)op < BIG_OP_COUNT) ? big_op_names[op] : "?";
+}
+
+/* início da medida: lfence antes e depois impede que o rdtsc troque de
+   lugar com o código anterior ou com a própria operação */
+static inline unsigned long long big_time_start(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    unsigned long long t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+/* fim da medida: rdtscp espera a operação terminar */
+static inline unsigned long long big_time_stop(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int aux;
+    unsigned long long t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#else
+    return big_time_start();
+#endif
+}
+
+/* dst += contadores de b */
+static void big_stats_accum(BigStats *dst, struct big_tls_buf *b) {
+    for (int i = 0; i < BIG_OP_COUNT; i++) {
+        struct big_op_ctr *c = &b->op[i];
+        dst->op[i].calls   += atomic_load_explicit(&c->calls, memory_order_relaxed);
+        dst->op[i].samples += atomic_load_explicit(&c->samples, memory_order_relaxed);
+        dst->op[i].cycles  += atomic_load_explicit(&c->cycles, memory_order_relaxed);
+        for (int k = 0; k < BIG_STATS_BUCKETS; k++)
+            dst->op[i].hist[k] += atomic_load_explicit(&c->hist[k], memory_order_relaxed);
+    }
+}
+
+/* destrutor de fim de thread: passa as contagens para big_retired e
+   devolve o buffer para a lista livre */
+static void big_tls_release(void *p) {
+    struct big_tls_buf *b = p;
+
+    pthread_mutex_lock(&big_lock);
+    big_stats_accum(&big_retired, b);
+    for (struct big_tls_buf **pp = &big_live; *pp != NULL; pp = &(*pp)->next) {
+        if (*pp == b) { *pp = b->next; break; }
+    }
+    memset(b->op, 0, sizeof b->op);   /* fora da lista ativa: ninguém mais lê */
+    b->next = big_free;
+    big_free = b;
+    pthread_mutex_unlock(&big_lock);
+
+    big_tls = NULL;
+}
+
+static void big_stats_init(void) {
+    pthread_key_create(&big_key, big_tls_release);
+
+    /* calibra: menor custo de um par início/fim sem nada no meio */
+    unsigned long long best = ~0ull;
+    for (int i = 0; i < 1000; i++) {
+        unsigned long long t0 = big_time_start();
+        unsigned long long t1 = big_time_stop();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    big_overhead = best;
+}
+
+/* primeira chamada da thread: pega um buffer (reusado ou novo) */
+static struct big_tls_buf *big_tls_register(void) {
+    pthread_once(&big_once, big_stats_init);
+
+    pthread_mutex_lock(&big_lock);
+    struct big_tls_buf *b = big_free;
+    if (b != NULL) {
+        big_free = b->next;
+    } else {
+        b = calloc(1, sizeof *b);
+        if (b != NULL) big_nbufs++;
+    }
+    if (b != NULL) {
+        b->next = big_live;
+        big_live = b;
+    }
+    pthread_mutex_unlock(&big_lock);
+
+    if (b == NULL) return NULL;     /* sem memória: simplesmente não mede */
+    pthread_setspecific(big_key, b);
+    big_tls = b;
+    return b;
+}
+
+static inline struct big_tls_buf *big_tls_get(void) {
+    return (big_tls != NULL) ? big_tls : big_tls_register();
+}
+
+/* incremento sem prefixo lock: só a thread dona escreve no contador */
+static inline void big_ctr_add(_Atomic unsigned long long *c, unsigned long long v) {
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + v,
+                          memory_order_relaxed);
+}
+
+struct big_trace {
+    int op;
+    struct big_op_ctr *c;       /* != NULL só se esta chamada é amostrada */
+    unsigned long long t0;
+};
+
+static inline struct big_trace big_trace_begin(enum big_op op) {
+    struct big_trace t = { (int)op, NULL, 0 };
+#ifdef BIG_HAVE_SDT
+    DTRACE_PROBE1(bigint, op_entry, (int)op);
+#endif
+    struct big_tls_buf *b = big_tls_get();
+    if (b == NULL) return t;
+
+    struct big_op_ctr *c = &b->op[op];
+    unsigned long long n = atomic_load_explicit(&c->calls, memory_order_relaxed);
+    atomic_store_explicit(&c->calls, n + 1, memory_order_relaxed);
+    if ((n & BIG_SAMPLE_MASK) == 0) {
+        t.c = c;
+        t.t0 = big_time_start();
+    }
+    return t;
+}
+
+/* chamada automaticamente na saída da função (atributo cleanup) */
+static inline void big_trace_end(struct big_trace *t) {
+    unsigned long long dt = 0;
+    if (t->c != NULL) {
+        dt = big_time_stop() - t->t0;
+        dt = (dt > big_overhead) ? dt - big_overhead : 0;
+
+        int k = (dt == 0) ? 0 : 63 - __builtin_clzll(dt);   /* floor(log2(dt)) */
+        if (k >= BIG_STATS_BUCKETS) k = BIG_STATS_BUCKETS - 1;
+
+        big_ctr_add(&t->c->samples, 1);
+        big_ctr_add(&t->c->cycles, dt);
+        big_ctr_add(&t->c->hist[k], 1);
+    }
+#ifdef BIG_HAVE_SDT
+    DTRACE_PROBE2(bigint, op_return, t->op, dt);   /* dt = 0 se não amostrada */
+#endif
+}
+
+#define BIG_TRACE(op) \
+    struct big_trace big_trace_ __attribute__((cleanup(big_trace_end))) = big_trace_begin(op)
+
+/* out = total bruto (threads encerradas + vivas); chamar com big_lock */
+static void big_stats_raw(BigStats *out) {
+    *out = big_retired;
+    for (struct big_tls_buf *b = big_live; b != NULL; b = b->next)
+        big_stats_accum(out, b);
+}
+
+void big_stats_snapshot(BigStats *out) {
+    BigStats raw;
+
+    pthread_mutex_lock(&big_lock);
+    big_stats_raw(&raw);
+    for (int i = 0; i < BIG_OP_COUNT; i++) {
+        BigOpStats *o = &out->op[i], *r = &raw.op[i], *z = &big_base.op[i];
+        o->calls   = r->calls   - z->calls;
+        o->samples = r->samples - z->samples;
+        o->cycles  = r->cycles  - z->cycles;
+        for (int k = 0; k < BIG_STATS_BUCKETS; k++)
+            o->hist[k] = r->hist[k] - z->hist[k];
+    }
+    pthread_mutex_unlock(&big_lock);
+}
+
+/* não escreve nos buffers das threads: só guarda a linha de base */
+void big_stats_reset(void) {
+    pthread_mutex_lock(&big_lock);
+    big_stats_raw(&big_base);
+    pthread_mutex_unlock(&big_lock);
+}
+
+int big_stats_buffers(void) {
+    pthread_mutex_lock(&big_lock);
+    int n = big_nbufs;
+    pthread_mutex_unlock(&big_lock);
+    return n;
+}
+
+void big_stats_dump(FILE *f) {
+    BigStats s;
+    big_stats_snapshot(&s);
+    fprintf(f, "# 1 a cada %llu chamadas medida; custo do trace (%llu %s) descontado\n",
+            BIG_SAMPLE_MASK + 1, big_overhead, BIG_TIME_UNIT);
+    fprintf(f, "%-12s %12s %10s %14s %10s\n", "op", "calls", "samples", BIG_TIME_UNIT, "avg");
+    for (int i = 0; i < BIG_OP_COUNT; i++) {
+        BigOpStats *o = &s.op[i];
+        if (o->calls == 0) continue;
+        fprintf(f, "%-12s %12llu %10llu %14llu %10.1f\n", big_op_names[i],
+                o->calls, o->samples, o->cycles,
+                o->samples ? (double)o->cycles / (double)o->samples : 0.0);
+        for (int k = 0; k < BIG_STATS_BUCKETS; k++) {
+            if (o->hist[k] == 0) continue;
+            if (k == 0)       /* inclui medidas que ficaram em 0 após descontar o trace */
+                fprintf(f, "    [0   , 2^1 ) %12llu\n", o->hist[k]);
+            else if (k == BIG_STATS_BUCKETS - 1)
+                fprintf(f, "    [2^%-2d, inf ) %12llu\n", k, o->hist[k]);
+            else
+                fprintf(f, "    [2^%-2d, 2^%-2d) %12llu\n", k, k + 1, o->hist[k]);
+        }
+    }
+}
+#else
+#define BIG_TRACE(op) ((void)0)
+#endif
+
+/* ==== caminhos rápidos de 64 bits ====
+   Em hosts little-endian com long de 64 bits e __int128, o BigInt é lido
+   como dois limbs de 64 bits (lo = bytes 0..7, hi = bytes 8..15).
+   Soma, subtração, negação, multiplicação e shifts viram uma única
+   operação de 128 bits.
+   -DBIGINT_NO_FAST64 força o caminho genérico byte a byte. */
+#if !defined(BIGINT_NO_FAST64) && defined(__SIZEOF_INT128__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && __SIZEOF_LONG__ == 8
+#define BIG_FAST64 1
+
+typedef unsigned __int128 big_u128;
+
+static inline big_u128 big_load128(const unsigned char *a) {
+    big_u128 v;
+    memcpy(&v, a, sizeof v);
+    return v;
+}
+
+static inline void big_store128(unsigned char *res, big_u128 v) {
+    memcpy(res, &v, sizeof v);
+}
+#endif
+
 /* res = val (extensão de sinal para 128 bits) */
-void big_val (BigInt res, long val){
+static inline void big_val_impl (BigInt res, long val){
     /* zera os 16 bytes do resultado (evita lixo nos bytes altos) */
     for (int i = 0; i < (int)sizeof(BigInt); i++) {  // <-- cast para (int)
         res[i] = 0;
@@ -36,8 +337,10 @@ void big_val (BigInt res, long val){
 }
 
 /* res = -a  (complemento de 2: ~a + 1) */
-void big_comp2(BigInt res, BigInt a){
-
+static inline void big_comp2_impl(BigInt res, BigInt a){
+#ifdef BIG_FAST64
+    big_store128(res, 0 - big_load128(a));
+#else
     unsigned int carry = 1; // inicia em 1 por causa do "+1" do complemento de 2
 
     for (int i = 0; i < (int)sizeof(BigInt); i++) {
@@ -46,11 +349,15 @@ void big_comp2(BigInt res, BigInt a){
         res[i] = (unsigned char)(soma & 0xFF);            // guarda só o byte atual
         carry = soma >> 8;                                // carry (vai-um) para o próximo byte
     }
+#endif
 }
 
 /* res = a + b (módulo 2^128) */
-void big_sum (BigInt res, BigInt a, BigInt b) {
-
+static inline void big_sum_impl (BigInt res, BigInt a, BigInt b) {
+#ifdef BIG_FAST64
+    /* uma soma de 128 bits cobre qualquer entrada */
+    big_store128(res, big_load128(a) + big_load128(b));
+#else
     unsigned int carry = 0;
 
     for (int i = 0; i < (int)sizeof(BigInt); i++) {
@@ -59,11 +366,14 @@ void big_sum (BigInt res, BigInt a, BigInt b) {
         res[i] = (unsigned char)(soma & 0xFF); // guarda só 8 bits
         carry = soma >> 8;                     // transbordo vira carry pro próximo byte
     }
+#endif
 }
 
 /* res = a - b (implementação por borrow) */
-void big_sub (BigInt res, BigInt a, BigInt b) {
-
+static inline void big_sub_impl (BigInt res, BigInt a, BigInt b) {
+#ifdef BIG_FAST64
+    big_store128(res, big_load128(a) - big_load128(b));
+#else
     unsigned int prox = 0; // "borrow" (empresta 1) do próximo byte
 
     for (int i = 0; i < (int)sizeof(BigInt); i++) {
@@ -78,11 +388,12 @@ void big_sub (BigInt res, BigInt a, BigInt b) {
 
         res[i] = (unsigned char)(sub & 0xFF);
     }
+#endif
 }
 
 /* res = a << n (deslocamento lógico à esquerda) */
 /* Little-endian: a[0] = LSB, a[15] = MSB. In-place SAFE via buffer temporário. */
-void big_shl (BigInt res, BigInt a, int n) {
+static inline void big_shl_impl (BigInt res, BigInt a, int n) {
     if (n <= 0) {                    /* n=0 (ou negativo): copia */
         if (res != a) memcpy(res, a, sizeof(BigInt));
         return;
@@ -92,6 +403,10 @@ void big_shl (BigInt res, BigInt a, int n) {
         return;
     }
 
+#ifdef BIG_FAST64
+    /* 0 < n < 128: um único shift de 128 bits */
+    big_store128(res, big_load128(a) << n);
+#else
     int byte_shift = n / 8;   /* deslocamento inteiro em bytes */
     int bit_shift  = n % 8;   /* deslocamento “miúdo” em bits  */
 
@@ -116,11 +431,12 @@ void big_shl (BigInt res, BigInt a, int n) {
 
     /* 3) escreve no destino (seguro mesmo se res == a) */
     memcpy(res, tmp, sizeof(BigInt));
+#endif
 }
 
 
 /* res = a >> n (lógico) */
-void big_shr (BigInt res, BigInt a, int n) {
+static inline void big_shr_impl (BigInt res, BigInt a, int n) {
     /* casos triviais */
     if (n <= 0) {
         memcpy(res, a, sizeof(BigInt));
@@ -132,6 +448,10 @@ void big_shr (BigInt res, BigInt a, int n) {
         return;
     }
 
+#ifdef BIG_FAST64
+    /* 0 < n < 128: um único shift de 128 bits */
+    big_store128(res, big_load128(a) >> n);
+#else
     /* separamos n em deslocamento de bytes e de bits */
     int byte_shift = n / 8;   /* quantos bytes inteiros mover */
     int bit_shift  = n % 8;   /* quantos bits dentro do byte */
@@ -160,11 +480,12 @@ void big_shr (BigInt res, BigInt a, int n) {
 
     /* 3) copia para o resultado (seguro mesmo se res == a) */
     memcpy(res, tmp, sizeof(BigInt));
+#endif
 }
 
 
 /* res = a >> n (aritmético: preserva o sinal) */
-void big_sar (BigInt res, BigInt a, int n) {
+static inline void big_sar_impl (BigInt res, BigInt a, int n) {
     /* casos triviais */
     if (n <= 0) {
         memcpy(res, a, sizeof(BigInt));
@@ -180,6 +501,10 @@ void big_sar (BigInt res, BigInt a, int n) {
         return;
     }
 
+#ifdef BIG_FAST64
+    /* 0 < n < 128: shift aritmético de 128 bits (GCC/Clang replicam o sinal) */
+    big_store128(res, (big_u128)((__int128)big_load128(a) >> n));
+#else
     int byte_shift = n / 8;
     int bit_shift  = n % 8;
 
@@ -207,10 +532,15 @@ void big_sar (BigInt res, BigInt a, int n) {
     }
 
     memcpy(res, tmp, sizeof(BigInt));
+#endif
 }
 
 /* res = a * b (módulo 2^128) via shift-and-add */
-void big_mul (BigInt res, BigInt a, BigInt b) {
+static inline void big_mul_impl (BigInt res, BigInt a, BigInt b) {
+#ifdef BIG_FAST64
+    /* produto de 128 bits truncado: exato módulo 2^128 para qualquer entrada */
+    big_store128(res, big_load128(a) * big_load128(b));
+#else
     BigInt acc; // acumulador do resultado parcial
     for (int i = 0; i < (int)sizeof(BigInt); i++) acc[i] = 0; // <-- cast para (int)
 
@@ -223,15 +553,101 @@ void big_mul (BigInt res, BigInt a, BigInt b) {
         for (int bit = 0; bit < 8; bit++) {
             if (bj & 1) {          // se o bit atual de b é 1
                 BigInt temp;       // soma o parcial: acc += sh
-                big_sum(temp, acc, sh);
+                big_sum_impl(temp, acc, sh);
                 memcpy(acc, temp, sizeof(BigInt));
             }
             BigInt temp2;
-            big_shl(temp2, sh, 1); // sh <<= 1 (prepara para o próximo bit)
+            big_shl_impl(temp2, sh, 1); // sh <<= 1 (prepara para o próximo bit)
             memcpy(sh, temp2, sizeof(BigInt));
             bj >>= 1;              // avança para o próximo bit do byte bj
         }
     }
 
     memcpy(res, acc, sizeof(BigInt)); // resultado final
-}
\ No newline at end of file
+#endif
+}
+
+/* res = a * b (b long, módulo 2^128) */
+static inline void big_mul_i64_impl (BigInt res, BigInt a, long b) {
+#ifdef BIG_FAST64
+    /* exato módulo 2^128 para qualquer a; testar se a cabe em 64 bits
+       (para usar um mul 64x64) não compensou no benchbigint */
+    big_store128(res, big_load128(a) * (big_u128)(__int128)b);
+#else
+    BigInt tb;
+    big_val_impl(tb, b);
+    big_mul_impl(res, a, tb);
+#endif
+}
+
+/* res = a + b (b long, módulo 2^128) */
+static inline void big_add_i64_impl (BigInt res, BigInt a, long b) {
+#ifdef BIG_FAST64
+    unsigned long lo, hi;
+    memcpy(&lo, a, sizeof lo);
+    memcpy(&hi, a + sizeof lo, sizeof hi);
+    unsigned long sum = lo + (unsigned long)b;
+    hi += (0ul - (b < 0)) + (sum < lo);   /* extensão de sinal de b + carry-out */
+    memcpy(res, &sum, sizeof sum);
+    memcpy(res + sizeof sum, &hi, sizeof hi);
+#else
+    BigInt tb;
+    big_val_impl(tb, b);
+    big_sum_impl(res, a, tb);
+#endif
+}
+
+/* ==== funções públicas ====
+   Cada uma só mede (BIG_TRACE) e delega para a versão _impl; as chamadas
+   internas entre operações usam _impl direto, então cada ciclo é contado
+   uma única vez, na operação que o usuário chamou. */
+
+void big_val (BigInt res, long val) {
+    BIG_TRACE(BIG_OP_VAL);
+    big_val_impl(res, val);
+}
+
+void big_comp2 (BigInt res, BigInt a) {
+    BIG_TRACE(BIG_OP_COMP2);
+    big_comp2_impl(res, a);
+}
+
+void big_sum (BigInt res, BigInt a, BigInt b) {
+    BIG_TRACE(BIG_OP_SUM);
+    big_sum_impl(res, a, b);
+}
+
+void big_sub (BigInt res, BigInt a, BigInt b) {
+    BIG_TRACE(BIG_OP_SUB);
+    big_sub_impl(res, a, b);
+}
+
+void big_shl (BigInt res, BigInt a, int n) {
+    BIG_TRACE(BIG_OP_SHL);
+    big_shl_impl(res, a, n);
+}
+
+void big_shr (BigInt res, BigInt a, int n) {
+    BIG_TRACE(BIG_OP_SHR);
+    big_shr_impl(res, a, n);
+}
+
+void big_sar (BigInt res, BigInt a, int n) {
+    BIG_TRACE(BIG_OP_SAR);
+    big_sar_impl(res, a, n);
+}
+
+void big_mul (BigInt res, BigInt a, BigInt b) {
+    BIG_TRACE(BIG_OP_MUL);
+    big_mul_impl(res, a, b);
+}
+
+void big_mul_i64 (BigInt res, BigInt a, long b) {
+    BIG_TRACE(BIG_OP_MUL_I64);
+    big_mul_i64_impl(res, a, b);
+}
+
+void big_add_i64 (BigInt res, BigInt a, long b) {
+    BIG_TRACE(BIG_OP_ADD_I64);
+    big_add_i64_impl(res, a, b);
+}
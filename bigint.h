@@ -20,6 +20,14 @@ void big_sub (BigInt res, BigInt a, BigInt b);
 /* res = a * b */
 void big_mul (BigInt res, BigInt a, BigInt b);
 
+/* Operacoes com o segundo operando long (sem montar um BigInt para b) */
+
+/* res = a * b */
+void big_mul_i64 (BigInt res, BigInt a, long b);
+
+/* res = a + b */
+void big_add_i64 (BigInt res, BigInt a, long b);
+
 /* Operacoes de deslocamento */
 
 /* res = a << n */
@@ -29,4 +37,55 @@ void big_shl (BigInt res, BigInt a, int n);
 void big_shr (BigInt res, BigInt a, int n);
 
 /* res = a >> n (aritmetico) */
-void big_sar(BigInt res, BigInt a, int n);
\ No newline at end of file
+void big_sar(BigInt res, BigInt a, int n);
+
+/* Instrumentacao (opcional)
+   compile com: gcc -DBIGINT_STATS -pthread -o testebigint bigint.c testebigint.c */
+
+#ifdef BIGINT_STATS
+#include <stdio.h>
+
+/* identifica cada operacao instrumentada */
+enum big_op {
+    BIG_OP_VAL, BIG_OP_COMP2, BIG_OP_SUM, BIG_OP_SUB, BIG_OP_MUL,
+    BIG_OP_SHL, BIG_OP_SHR, BIG_OP_SAR, BIG_OP_MUL_I64, BIG_OP_ADD_I64,
+    BIG_OP_COUNT
+};
+
+/* 1 a cada 2^BIG_STATS_SAMPLE_SHIFT chamadas de cada operacao tem o tempo
+   medido; as chamadas sao sempre contadas todas */
+#ifndef BIG_STATS_SAMPLE_SHIFT
+#define BIG_STATS_SAMPLE_SHIFT 6
+#endif
+
+/* histograma log2: bucket k conta medidas com 2^k <= t < 2^(k+1);
+   o bucket 0 inclui t = 0 e o ultimo acumula tudo acima de 2^(BIG_STATS_BUCKETS-1) */
+#define BIG_STATS_BUCKETS 32
+
+/* tempo em ciclos (rdtsc) em x86; em nanossegundos nas outras arquiteturas */
+typedef struct {
+    unsigned long long calls;                    /* numero exato de chamadas */
+    unsigned long long samples;                  /* chamadas com tempo medido */
+    unsigned long long cycles;                   /* soma do tempo das medidas */
+    unsigned long long hist[BIG_STATS_BUCKETS];  /* distribuicao do tempo das medidas */
+} BigOpStats;
+
+typedef struct {
+    BigOpStats op[BIG_OP_COUNT];
+} BigStats;
+
+/* out = contadores de todas as threads (vivas ou encerradas) desde o ultimo reset */
+void big_stats_snapshot(BigStats *out);
+
+/* zera os contadores vistos por big_stats_snapshot */
+void big_stats_reset(void);
+
+/* numero de buffers por thread ja alocados (reusados quando uma thread termina) */
+int big_stats_buffers(void);
+
+/* imprime um resumo legivel (chamadas, amostras, tempo medio, histograma) em f */
+void big_stats_dump(FILE *f);
+
+/* nome da operacao ("big_mul", ...) */
+const char *big_op_name(enum big_op op);
+#endif
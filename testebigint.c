@@ -5,6 +5,9 @@
 #include <string.h>
 #include <assert.h>
 #include "bigint.h"
+#ifdef BIGINT_STATS
+#include <pthread.h>
+#endif
 
 /* ==== utilitários de teste ==== */
 
@@ -413,6 +416,131 @@ static void test_props(void) {
     }
 }
 
+#if defined(__GNUC__) || defined(__clang__)
+/* converte um __int128 para BigInt (little-endian) */
+static void from_i128(BigInt out, __int128 m) {
+    for (int i=0;i<16;i++) out[i] = (unsigned char)(((unsigned __int128)m >> (8*i)) & 0xFFu);
+}
+
+static void test_i64(void) {
+    /* mistura de valores pequenos (cabem em long) e de 128 bits completos */
+    __int128 V[] = {
+        0, 1, -1, 42, -42, 0x7FFFFFFFFFFFFFFFL, (long)0x8000000000000000,
+        (__int128)0x7FFFFFFFFFFFFFFFL + 1,          /* 2^63: não cabe em long */
+        -(__int128)0x7FFFFFFFFFFFFFFFL - 2,         /* -2^63-1 */
+        ((__int128)0x0123456789ABCDEFL << 64) | 0x0FEDCBA987654321L,
+        -(((__int128)0x1122334455667788L << 64) | 0x99AABBCCDDEEFF00uL)
+    };
+    long L[] = {0, 1, -1, 7, -7, 0x7FFFFFFFFFFFFFFFL, (long)0x8000000000000000, 0x12345678L};
+    int NV = (int)(sizeof(V)/sizeof(V[0]));
+    int NL = (int)(sizeof(L)/sizeof(L[0]));
+
+    for (int i=0;i<NV;i++) {
+        for (int j=0;j<NL;j++) {
+            BigInt a, b, r, e;
+            from_i128(a, V[i]);
+            from_long(b, L[j]);
+
+            from_i128(e, (__int128)((unsigned __int128)V[i] * (unsigned __int128)(__int128)L[j]));
+            big_mul_i64(r, a, L[j]); expect_equal("mul_i64 == oracle", r, e);
+            big_mul(r, a, b);        expect_equal("mul (misto) == oracle", r, e);
+
+            from_i128(e, (__int128)((unsigned __int128)V[i] + (unsigned __int128)(__int128)L[j]));
+            big_add_i64(r, a, L[j]); expect_equal("add_i64 == oracle", r, e);
+            big_sum(r, a, b);        expect_equal("sum (misto) == oracle", r, e);
+        }
+    }
+
+    /* in-place (res == a) */
+    {
+        BigInt a, e;
+        from_long(a, -9); from_long(e, 27);
+        big_mul_i64(a, a, -3); expect_equal("mul_i64 in-place", a, e);
+        from_long(e, 30);
+        big_add_i64(a, a, 3);  expect_equal("add_i64 in-place", a, e);
+    }
+}
+#endif
+
+#ifdef BIGINT_STATS
+#define STATS_THREADS 8
+#define STATS_CALLS   1000
+#define STATS_ROUNDS  4
+
+/* cada thread faz STATS_CALLS somas no seu próprio buffer */
+static void *stats_worker(void *arg) {
+    BigInt a, r;
+    (void)arg;
+    memset(a, 0, sizeof(BigInt));
+    for (int i = 0; i < STATS_CALLS; i++) big_sum(r, a, a);
+    return NULL;
+}
+
+static void test_stats(void) {
+    BigInt a, b, r;
+    BigStats s;
+
+    big_stats_reset();
+    from_long(a, 3); from_long(b, -4);
+    big_sum(r, a, b);
+    big_sum(r, r, b);
+    big_shr(r, a, 1);
+
+    big_stats_snapshot(&s);
+    assert(s.op[BIG_OP_VAL].calls == 2);
+    assert(s.op[BIG_OP_SUM].calls == 2);
+    assert(s.op[BIG_OP_SHR].calls == 1);
+    assert(s.op[BIG_OP_SAR].calls == 0);
+
+    /* histograma soma o mesmo que samples; samples é só uma fração de calls */
+    unsigned long long h = 0;
+    for (int k = 0; k < BIG_STATS_BUCKETS; k++) h += s.op[BIG_OP_SUM].hist[k];
+    assert(h == s.op[BIG_OP_SUM].samples);
+    assert(s.op[BIG_OP_SUM].samples <= s.op[BIG_OP_SUM].calls);
+
+    big_stats_dump(stdout);
+    big_stats_reset();
+    big_stats_snapshot(&s);
+    assert(s.op[BIG_OP_SUM].calls == 0);
+
+    /* big_mul de 128 bits: só big_mul é contado, não as somas/shifts internos */
+    memset(a, 0xA5, sizeof(BigInt));
+    memset(b, 0x5A, sizeof(BigInt));
+    big_stats_reset();
+    big_mul(r, a, b);
+    big_stats_snapshot(&s);
+    assert(s.op[BIG_OP_MUL].calls == 1);
+    assert(s.op[BIG_OP_SUM].calls == 0);
+    assert(s.op[BIG_OP_SHL].calls == 0);
+
+    /* várias levas de threads: snapshot soma todos os buffers, inclusive de
+       threads já encerradas, e os buffers são reusados (não crescem por leva) */
+    {
+        pthread_t th[STATS_THREADS];
+        unsigned long long per_thread =
+            (STATS_CALLS + (1ull << BIG_STATS_SAMPLE_SHIFT) - 1) >> BIG_STATS_SAMPLE_SHIFT;
+
+        big_stats_reset();
+        for (int round = 0; round < STATS_ROUNDS; round++) {
+            for (int i = 0; i < STATS_THREADS; i++) {
+                int rc = pthread_create(&th[i], NULL, stats_worker, NULL);
+                assert(rc == 0); (void)rc;
+            }
+            for (int i = 0; i < STATS_THREADS; i++)
+                pthread_join(th[i], NULL);
+        }
+        big_stats_snapshot(&s);
+        assert(s.op[BIG_OP_SUM].calls == (unsigned long long)STATS_ROUNDS * STATS_THREADS * STATS_CALLS);
+        assert(s.op[BIG_OP_SUM].samples == (unsigned long long)STATS_ROUNDS * STATS_THREADS * per_thread);
+        assert(big_stats_buffers() <= STATS_THREADS + 1);   /* + a thread principal */
+
+        big_stats_reset();
+        big_stats_snapshot(&s);
+        assert(s.op[BIG_OP_SUM].calls == 0);
+    }
+    printf("OK  : contadores de instrumentação (BIGINT_STATS)\n");
+}
+#endif
 
 
 /* ==== MAIN: executa todos os testes ==== */
@@ -426,6 +554,12 @@ int main(void) {
     test_shift_matrix();   
     test_props();          
     test_mul();
+#if defined(__GNUC__) || defined(__clang__)
+    test_i64();
+#endif
+#ifdef BIGINT_STATS
+    test_stats();
+#endif
     printf("=== Todos os testes passaram. ===\n");
     return 0;
 }